@@ -3,12 +3,17 @@
 #include <vector>
 #include <complex>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include "fft_backend.h"
 
 namespace audio {
 
 /**
- * FFT-based audio analyzer using Cooley-Tukey algorithm
+ * FFT-based audio analyzer
+ * The FFT kernel is chosen per size by FFTPlanner::global(); any size >= 2
+ * works (radix-2, mixed-radix 2/3/5 or Bluestein). Initialized kernels are
+ * cached per size so switching sizes back and forth does not rebuild tables.
  */
 class AudioAnalyzer {
 public:
@@ -31,20 +36,25 @@ public:
     // Get last FFT computation time in milliseconds
     double get_last_fft_time_ms() const { return last_fft_time_ms_; }
 
+    // Name of the active FFT backend, empty if the size is unsupported
+    const char* backend_name() const { return backend_ ? backend_->name() : ""; }
+
+    // Drop cached plans and ask the planner again for the current size
+    // (after forcing a backend or importing wisdom)
+    void replan();
+
 private:
-    // FFT helper methods
-    void init_fft_tables();
-    void compute_fft(std::vector<std::complex<float>>& data);
+    void init_window();
+    void select_backend();
 
     size_t fft_size_;
     std::vector<float> magnitude_;
     std::vector<float> window_;
+    std::vector<std::complex<float>> complex_input_;
     double last_fft_time_ms_ = 0.0;
 
-    // FFT precomputed tables
-    std::vector<uint32_t> bit_reversed_;
-    std::vector<float> twiddle_cos_;
-    std::vector<float> twiddle_sin_;
+    std::map<size_t, std::unique_ptr<FFTBackend>> plans_;
+    FFTBackend* backend_ = nullptr;
 };
 
 } // namespace audio
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <memory>
+
+namespace audio {
+
+/**
+ * Interface for a forward complex FFT kernel of a fixed size
+ * AudioAnalyzer calls through this so kernels can be compared and swapped
+ */
+class FFTBackend {
+public:
+    virtual ~FFTBackend() = default;
+
+    // Short identifier used in wisdom files and the JS API
+    virtual const char* name() const = 0;
+
+    // Whether this kernel can transform n points
+    virtual bool supports(size_t n) const = 0;
+
+    // Precompute tables for n points (called once per size)
+    virtual void init(size_t n) = 0;
+
+    // In-place forward transform, data.size() must equal the init() size
+    // Output is unnormalized: X[k] = sum x[n] * e^(-2πikn/N)
+    virtual void forward(std::vector<std::complex<float>>& data) = 0;
+};
+
+/**
+ * In-house iterative radix-2 Cooley-Tukey with precomputed tables
+ */
+class RadixTwoFFT : public FFTBackend {
+public:
+    const char* name() const override { return "radix2"; }
+    bool supports(size_t n) const override;
+    void init(size_t n) override;
+    void forward(std::vector<std::complex<float>>& data) override;
+
+private:
+    std::vector<uint32_t> bit_reversed_;
+    std::vector<float> twiddle_cos_;
+    std::vector<float> twiddle_sin_;
+    std::vector<std::complex<float>> scratch_;
+};
+
+/**
+ * Scalar reference radix-2 FFT with no precomputed tables
+ * Slow on purpose; kept as a correctness and timing baseline
+ */
+class ReferenceFFT : public FFTBackend {
+public:
+    const char* name() const override { return "reference"; }
+    bool supports(size_t n) const override;
+    void init(size_t n) override;
+    void forward(std::vector<std::complex<float>>& data) override;
+
+private:
+    size_t log2n_ = 0;
+};
+
+/**
+ * Recursive mixed-radix FFT for sizes of the form 2^a * 3^b * 5^c
+ * (e.g. 1600 or 1920 samples for 30/25 fps at 48 kHz)
+ */
+class MixedRadixFFT : public FFTBackend {
+public:
+    const char* name() const override { return "mixed_radix"; }
+    bool supports(size_t n) const override;
+    void init(size_t n) override;
+    void forward(std::vector<std::complex<float>>& data) override;
+
+private:
+    void work(std::complex<float>* out, const std::complex<float>* in,
+              size_t fstride, size_t stage);
+    void butterfly2(std::complex<float>* out, size_t fstride, size_t m);
+    void butterfly3(std::complex<float>* out, size_t fstride, size_t m);
+    void butterfly4(std::complex<float>* out, size_t fstride, size_t m);
+    void butterfly_generic(std::complex<float>* out, size_t fstride,
+                           size_t m, size_t p);
+
+    size_t n_ = 0;
+    std::vector<size_t> radices_;      // radix of each stage
+    std::vector<size_t> spans_;        // sub-transform length after each stage
+    std::vector<std::complex<float>> twiddles_;  // e^(-2πik/N), k < N
+    std::vector<std::complex<float>> input_;
+    std::vector<std::complex<float>> scratch_;   // generic butterfly
+};
+
+/**
+ * Bluestein (chirp-z) FFT for arbitrary sizes
+ * Rewrites an N-point DFT as a convolution computed with power-of-two FFTs
+ * of length M >= 2N - 1
+ */
+class BluesteinFFT : public FFTBackend {
+public:
+    const char* name() const override { return "bluestein"; }
+    bool supports(size_t n) const override;
+    void init(size_t n) override;
+    void forward(std::vector<std::complex<float>>& data) override;
+
+private:
+    size_t n_ = 0;
+    RadixTwoFFT fft_;
+    std::vector<std::complex<float>> chirp_;          // e^(-iπk²/N), k < N
+    std::vector<std::complex<float>> kernel_spectrum_;  // FFT of conj chirp
+    std::vector<std::complex<float>> work_;
+};
+
+#ifdef AUDIO_HAS_DJ_FFT
+/**
+ * Wrapper around the dj_fft submodule (src/third_party/dj_fft)
+ */
+class DjFFT : public FFTBackend {
+public:
+    const char* name() const override { return "dj_fft"; }
+    bool supports(size_t n) const override;
+    void init(size_t n) override;
+    void forward(std::vector<std::complex<float>>& data) override;
+
+private:
+    float scale_ = 1.0f;
+    bool inverse_ = false;  // dj_fft's sign convention is flipped, use DIR_BWD
+};
+#endif
+
+// Create a backend by name, returns nullptr for unknown names
+std::unique_ptr<FFTBackend> create_fft_backend(const char* name);
+
+// Names of all backends compiled into this build
+const std::vector<const char*>& fft_backend_names();
+
+} // namespace audio
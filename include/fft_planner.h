@@ -0,0 +1,50 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "fft_backend.h"
+
+namespace audio {
+
+/**
+ * FFTW-style "measure" planner
+ * Times every compiled-in backend once per FFT size and remembers the fastest.
+ * The choices ("wisdom") can be exported and re-imported so later sessions
+ * skip the measurement. Wisdom is tagged with the build target because the
+ * best kernel differs between e.g. wasm SIMD and native builds.
+ */
+class FFTPlanner {
+public:
+    // Process-wide planner shared by all analyzers
+    static FFTPlanner& global();
+
+    // Create an initialized backend for n points
+    // Uses the forced backend, then wisdom, and measures only as a last resort
+    std::unique_ptr<FFTBackend> plan(size_t n);
+
+    // Time all backends for n points, record and return the fastest name
+    std::string measure(size_t n);
+
+    // Force a backend by name for every size it supports; other sizes keep
+    // the measured choice (the backend actually running is reported by
+    // AudioAnalyzer::backend_name())
+    // Empty string restores automatic selection, returns false for unknown names
+    bool force_backend(const std::string& name);
+
+    // Serialize / restore wisdom ("<size> <backend>" per line)
+    // import_wisdom() rejects text produced for a different target
+    std::string export_wisdom() const;
+    bool import_wisdom(const std::string& text);
+
+    // Build target tag written into the wisdom header
+    static const char* target();
+
+private:
+    std::map<size_t, std::string> wisdom_;
+    std::string forced_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace audio
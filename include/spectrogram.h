@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace audio {
+
+/**
+ * Scrolling spectrogram (waterfall) image kept in linear memory
+ * Each push() maps one magnitude frame through a dB -> palette lookup into
+ * a single column and advances the write index, so the cost per frame is
+ * O(num_bins) regardless of history length.
+ *
+ * Memory layout is column-major: column c starts at c * num_bins texels and
+ * bin 0 (lowest frequency) comes first. JS can upload just the dirty column
+ * or wrap the whole buffer as a typed-array view; the oldest column is at
+ * write_index().
+ */
+class Spectrogram {
+public:
+    enum class Format {
+        RGBA8,  // 4 bytes per texel, palette applied
+        R8      // 1 byte per texel, palette index (palette applied by shader)
+    };
+
+    Spectrogram(size_t num_bins, size_t history, Format format = Format::RGBA8);
+
+    // Reallocate for a new bin count / history length (clears the image)
+    void resize(size_t num_bins, size_t history);
+
+    // Map magnitudes to dB relative to ref_magnitude and clamp to
+    // [min_db, max_db] before the palette lookup
+    void set_range(float min_db, float max_db, float ref_magnitude);
+
+    // Replace the 256-entry palette (RGBA8, R in the lowest byte)
+    // Existing columns keep their old colors until cleared
+    void set_palette(const uint32_t* rgba);
+
+    // Write one column from num_bins magnitudes, returns the column written
+    size_t push(const float* magnitude);
+
+    // Write `count` blank columns (palette index 0) for frames with no data,
+    // at most history columns; returns the first column written
+    size_t push_blank(size_t count);
+
+    // Fill the image with palette index 0
+    void clear();
+
+    const uint8_t* pixels() const { return pixels_.data(); }
+    size_t bytes_per_texel() const { return format_ == Format::RGBA8 ? 4 : 1; }
+    size_t column_bytes() const { return num_bins_ * bytes_per_texel(); }
+
+    size_t num_bins() const { return num_bins_; }
+    size_t history() const { return history_; }
+    size_t write_index() const { return write_index_; }
+    Format format() const { return format_; }
+
+private:
+    void update_mapping();
+
+    size_t num_bins_;
+    size_t history_;
+    Format format_;
+    size_t write_index_ = 0;
+
+    float min_db_ = -100.0f;
+    float max_db_ = 0.0f;
+    float ref_magnitude_ = 1.0f;
+
+    // palette index = scale_ * log2(magnitude) + offset_
+    float scale_ = 0.0f;
+    float offset_ = 0.0f;
+
+    std::vector<uint32_t> palette_;
+    std::vector<uint8_t> pixels_;
+};
+
+} // namespace audio
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <thread>
+#endif
+
+#include "audio_analyzer.h"
+
+namespace audio {
+
+/**
+ * Ring of spectrum frames computed ahead of the playback position
+ * Frame k covers samples [k * hop, k * hop + fft_size). The render loop
+ * calls fetch() with the current sample offset and gets a finished frame;
+ * the frames after it are produced by a worker thread (pthreads builds)
+ * or by pump() from JS idle callbacks. A frame that is not ready yet is
+ * computed synchronously so fetch() never returns stale data.
+ */
+class SpectrumQueue {
+public:
+    // samples must stay alive and unchanged for the lifetime of the queue
+    SpectrumQueue(const float* samples, size_t num_samples,
+                  size_t capacity = 32);
+    ~SpectrumQueue();
+
+    SpectrumQueue(const SpectrumQueue&) = delete;
+    SpectrumQueue& operator=(const SpectrumQueue&) = delete;
+
+    // Change FFT size / hop (in samples), drops every queued frame
+    void configure(size_t fft_size, size_t hop);
+
+    // Move the playback position, frames still inside the new window are kept
+    void seek(size_t sample_offset);
+
+    // Re-select FFT backends after the planner changed (forced backend,
+    // new wisdom); drops every queued frame. Each analyzer replans on the
+    // thread that owns it before its next frame.
+    void replan();
+
+    // Spectrum (fft_size / 2 bins) for the frame containing sample_offset,
+    // nullptr when the frame would run past the end of the audio
+    // The pointer is valid only until the next fetch(), seek(), configure()
+    // or replan() call: once the playhead moves, the slot can be reused for
+    // a later frame (immediately by the worker in pthreads builds)
+    const float* fetch(size_t sample_offset);
+
+    // Frame containing sample_offset only if it is already in the ring;
+    // never computes and does not move the playback position. The pointer
+    // is valid until the playback position moves.
+    const float* peek(size_t sample_offset) const;
+
+    // Produce queued frames until budget_ms elapses or the ring is full
+    // Returns the number of frames produced
+    size_t pump(double budget_ms);
+
+    // Frames ready ahead of the playback position
+    size_t depth() const;
+
+    // Backend that produced the most recent frame ("" before the first one)
+    const char* backend_name() const;
+
+    size_t fft_size() const { return fft_size_; }
+    size_t hop() const { return hop_; }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+private:
+    struct Frame {
+        int64_t index = -1;  // frame number held in this slot, -1 = empty
+        std::vector<float> magnitude;
+    };
+
+    struct Job {
+        int64_t index = 0;
+        uint64_t generation = 0;
+        size_t fft_size = 0;
+        size_t hop = 0;
+        bool replan = false;  // analyzer must drop its cached plans first
+    };
+
+    // Claim the next frame to produce (mutex_ held), skipping frames that
+    // are already in the ring
+    // Returns false when the ring is full or the audio has ended
+    bool claim_job(Job& job);
+
+    // Compute a claimed frame with the given analyzer (no lock held)
+    const float* compute(AudioAnalyzer& analyzer, const Job& job) const;
+
+    // Store a produced frame if it is still wanted
+    void commit(const Job& job, const float* magnitude, const char* backend);
+
+    bool frame_in_range(int64_t index) const;
+    bool frame_in_audio(int64_t index) const;
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    void worker_loop();
+    std::thread worker_;
+    bool stop_ = false;
+#endif
+
+    const float* samples_;
+    size_t num_samples_;
+    size_t capacity_;
+    size_t fft_size_ = 0;
+    size_t hop_ = 0;
+
+    std::vector<Frame> ring_;
+    int64_t playhead_ = 0;  // frame currently shown
+    int64_t next_ = 0;      // next frame to produce
+    uint64_t generation_ = 0;
+    bool producer_replan_ = false;
+    bool sync_replan_ = false;
+    const char* backend_name_ = "";
+
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    // Separate analyzers so the producer never races the render thread
+    std::unique_ptr<AudioAnalyzer> producer_analyzer_;
+    std::unique_ptr<AudioAnalyzer> sync_analyzer_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+};
+
+} // namespace audio
@@ -2,12 +2,18 @@
 #include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <string>
 #include "audio_decoder.h"
 #include "audio_analyzer.h"
+#include "fft_planner.h"
+#include "spectrum_queue.h"
+#include "spectrogram.h"
 
 // 전역 상태 (디코더와 분석기 인스턴스)
 static std::unique_ptr<audio::AudioDecoder> g_decoder;
 static std::unique_ptr<audio::AudioAnalyzer> g_analyzer;
+static std::unique_ptr<audio::SpectrumQueue> g_queue;
+static std::unique_ptr<audio::Spectrogram> g_spectrogram;
 
 extern "C" {
 
@@ -23,6 +29,9 @@ int loadAudio(const uint8_t* data, size_t size) {
         g_decoder = std::make_unique<audio::AudioDecoder>();
     }
 
+    // 큐가 이전 샘플을 참조하고 있으므로 디코딩 전에 정리 (워커 스레드 종료)
+    g_queue.reset();
+
     bool success = g_decoder->load(data, size);
 
     if (success) {
@@ -43,12 +52,12 @@ int loadAudio(const uint8_t* data, size_t size) {
 /**
  * 특정 샘플 오프셋에서 FFT 스펙트럼 데이터 가져오기 (실시간 재생용)
  * sample_offset: FFT를 시작할 샘플 위치
- * fft_size: FFT 크기 (2의 거듭제곱이어야 함)
+ * fft_size: FFT 크기 (2 이상, 2의 거듭제곱이 아니어도 됨)
  * 반환값: 주파수 크기 스펙트럼 배열 포인터 (길이는 fft_size/2)
  */
 EMSCRIPTEN_KEEPALIVE
 const float* getFFTDataAtOffset(int sample_offset, int fft_size) {
-    if (!g_decoder || !g_decoder->is_loaded()) {
+    if (!g_decoder || !g_decoder->is_loaded() || fft_size < 2) {
         return nullptr;
     }
 
@@ -73,6 +82,181 @@ const float* getFFTDataAtOffset(int sample_offset, int fft_size) {
     return g_analyzer->analyze(samples.data() + sample_offset, samples_available);
 }
 
+/**
+ * 스펙트럼 큐 설정 (미리 계산할 프레임의 FFT 크기와 간격)
+ * FFT 크기나 홉이 바뀌면 큐에 있던 프레임은 모두 무효화됨
+ * fft_size: FFT 크기
+ * hop: 프레임 간격 (샘플 단위)
+ * 반환값: 성공 시 1, 오디오가 로드되지 않았으면 0
+ */
+EMSCRIPTEN_KEEPALIVE
+int configureSpectrumQueue(int fft_size, int hop) {
+    if (!g_decoder || !g_decoder->is_loaded() || fft_size < 2 || hop < 1) {
+        return 0;
+    }
+
+    if (!g_queue) {
+        const auto& samples = g_decoder->samples();
+        g_queue = std::make_unique<audio::SpectrumQueue>(samples.data(),
+                                                         samples.size());
+    }
+    g_queue->configure(fft_size, hop);
+    return 1;
+}
+
+/**
+ * 큐에서 재생 위치에 해당하는 스펙트럼 프레임 가져오기 (렌더 루프용)
+ * 미리 계산된 프레임이 없으면 즉시 계산하여 반환
+ * sample_offset: 현재 재생 위치 (샘플)
+ * 반환값: 주파수 크기 스펙트럼 배열 포인터 (길이는 fft_size/2), 끝에 도달하면 nullptr
+ *         다음 큐 호출(getQueuedFFTData/seek/configure/백엔드 변경) 전까지만 유효하므로 즉시 읽을 것
+ */
+EMSCRIPTEN_KEEPALIVE
+const float* getQueuedFFTData(int sample_offset) {
+    if (!g_queue || sample_offset < 0) {
+        return nullptr;
+    }
+    return g_queue->fetch(sample_offset);
+}
+
+/**
+ * 큐에 이미 준비된 프레임만 가져오기 (동기 계산 없음, 재생 위치 유지)
+ * 렌더가 밀려 건너뛴 프레임을 스펙트로그램에 채울 때 사용
+ * sample_offset: 프레임 시작 위치 (샘플)
+ * 반환값: 스펙트럼 배열 포인터, 준비되지 않았으면 nullptr
+ */
+EMSCRIPTEN_KEEPALIVE
+const float* peekQueuedFFTData(int sample_offset) {
+    if (!g_queue || sample_offset < 0) {
+        return nullptr;
+    }
+    return g_queue->peek(sample_offset);
+}
+
+/**
+ * 재생 위치 점프 알림 (정지/탐색 시)
+ * sample_offset: 새 재생 위치 (샘플)
+ */
+EMSCRIPTEN_KEEPALIVE
+void seekSpectrumQueue(int sample_offset) {
+    if (g_queue && sample_offset >= 0) {
+        g_queue->seek(sample_offset);
+    }
+}
+
+/**
+ * 유휴 시간에 다음 프레임들을 미리 계산 (pthread 빌드에서는 워커가 처리하므로 0 반환)
+ * budget_ms: 사용할 수 있는 최대 시간 (밀리초)
+ * 반환값: 계산한 프레임 수
+ */
+EMSCRIPTEN_KEEPALIVE
+int pumpSpectrumQueue(double budget_ms) {
+    if (!g_queue) {
+        return 0;
+    }
+    return static_cast<int>(g_queue->pump(budget_ms));
+}
+
+/**
+ * 재생 위치 이후로 준비된 프레임 수 반환 (성능 모니터링용)
+ */
+EMSCRIPTEN_KEEPALIVE
+int getSpectrumQueueDepth() {
+    if (!g_queue) {
+        return 0;
+    }
+    return static_cast<int>(g_queue->depth());
+}
+
+/**
+ * 스펙트로그램 링 텍스처 생성 (기존 이미지는 폐기)
+ * num_bins: 열 하나의 높이 (fft_size/2)
+ * history: 보관할 열 개수
+ * single_channel: 1이면 팔레트 인덱스(R8), 0이면 RGBA8
+ * 반환값: 성공 시 1, 실패 시 0
+ */
+EMSCRIPTEN_KEEPALIVE
+int createSpectrogram(int num_bins, int history, int single_channel) {
+    if (num_bins <= 0 || history <= 0) {
+        return 0;
+    }
+    const auto format = single_channel ? audio::Spectrogram::Format::R8
+                                       : audio::Spectrogram::Format::RGBA8;
+    g_spectrogram = std::make_unique<audio::Spectrogram>(num_bins, history, format);
+    return 1;
+}
+
+/**
+ * dB 표시 범위 설정
+ * min_db, max_db: 팔레트 양 끝에 대응하는 dB
+ * ref_magnitude: 0 dB 기준 크기 (Hann 윈도우 기준 풀스케일 사인파는 fft_size/4)
+ */
+EMSCRIPTEN_KEEPALIVE
+void setSpectrogramRange(float min_db, float max_db, float ref_magnitude) {
+    if (g_spectrogram) {
+        g_spectrogram->set_range(min_db, max_db, ref_magnitude);
+    }
+}
+
+/**
+ * 256색 팔레트 교체 (RGBA8, 이후 기록되는 열부터 적용)
+ * rgba: 256개 uint32 배열 포인터
+ */
+EMSCRIPTEN_KEEPALIVE
+void setSpectrogramPalette(const uint32_t* rgba) {
+    if (g_spectrogram && rgba) {
+        g_spectrogram->set_palette(rgba);
+    }
+}
+
+/**
+ * 스펙트럼 프레임 하나를 열로 기록 (getQueuedFFTData 등의 결과를 그대로 전달)
+ * magnitude: 크기 스펙트럼 배열 포인터 (길이는 num_bins)
+ * 반환값: 기록된 열 인덱스, 실패 시 -1
+ */
+EMSCRIPTEN_KEEPALIVE
+int pushSpectrogramColumn(const float* magnitude) {
+    if (!g_spectrogram || !magnitude) {
+        return -1;
+    }
+    return static_cast<int>(g_spectrogram->push(magnitude));
+}
+
+/**
+ * 데이터가 없는 프레임만큼 빈 열 기록 (시간축 간격 유지용, 최대 history 열)
+ * count: 빈 열 개수
+ * 반환값: 처음 기록한 열 인덱스, 스펙트로그램이 없으면 -1
+ */
+EMSCRIPTEN_KEEPALIVE
+int pushSpectrogramBlank(int count) {
+    if (!g_spectrogram || count <= 0) {
+        return -1;
+    }
+    return static_cast<int>(g_spectrogram->push_blank(count));
+}
+
+/**
+ * 스펙트로그램 링 텍스처 포인터 반환 (열 우선 배치, 열 하나 = num_bins 텍셀)
+ */
+EMSCRIPTEN_KEEPALIVE
+const uint8_t* getSpectrogramPixels() {
+    if (!g_spectrogram) {
+        return nullptr;
+    }
+    return g_spectrogram->pixels();
+}
+
+/**
+ * 다음에 기록될 열 인덱스 반환 (= 가장 오래된 열)
+ */
+EMSCRIPTEN_KEEPALIVE
+int getSpectrogramWriteIndex() {
+    if (!g_spectrogram) {
+        return 0;
+    }
+    return static_cast<int>(g_spectrogram->write_index());
+}
+
 /**
  * 총 오디오 샘플 개수 반환
  * 반환값: 샘플 개수
@@ -138,4 +322,111 @@ double getLastFFTTime() {
     return g_analyzer->get_last_fft_time_ms();
 }
 
+/**
+ * 주어진 크기에 대해 모든 FFT 백엔드를 측정하고 가장 빠른 것을 기록 (시작 시 자동 튜닝용)
+ * fft_size: 측정할 FFT 크기
+ * 반환값: 선택된 백엔드가 있으면 1, 지원하는 백엔드가 없으면 0
+ */
+EMSCRIPTEN_KEEPALIVE
+int tuneFFT(int fft_size) {
+    if (fft_size < 2) {
+        return 0;
+    }
+    std::string chosen = audio::FFTPlanner::global().measure(fft_size);
+    if (chosen.empty()) {
+        return 0;
+    }
+    if (g_analyzer && g_analyzer->fft_size() == static_cast<size_t>(fft_size)) {
+        g_analyzer->replan();
+    }
+    if (g_queue && g_queue->fft_size() == static_cast<size_t>(fft_size)) {
+        g_queue->replan();
+    }
+    return 1;
+}
+
+/**
+ * FFT 백엔드 강제 지정 (비교용)
+ * name: "radix2", "mixed_radix", "bluestein", "reference", "dj_fft"
+ *       또는 빈 문자열(자동 선택)
+ * 반환값: 성공 시 1, 알 수 없는 이름이면 0
+ */
+EMSCRIPTEN_KEEPALIVE
+int setFFTBackend(const char* name) {
+    if (!audio::FFTPlanner::global().force_backend(name ? name : "")) {
+        return 0;
+    }
+    if (g_analyzer) {
+        g_analyzer->replan();
+    }
+    if (g_queue) {
+        g_queue->replan();
+    }
+    return 1;
+}
+
+/**
+ * 이 빌드에 포함된 FFT 백엔드 이름 목록 (UI 선택지 구성용)
+ * 반환값: 쉼표로 구분된 이름 문자열 (예: "radix2,mixed_radix,bluestein,reference")
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* getFFTBackendNames() {
+    static std::string names;
+    if (names.empty()) {
+        for (const char* name : audio::fft_backend_names()) {
+            if (!names.empty()) {
+                names += ',';
+            }
+            names += name;
+        }
+    }
+    return names.c_str();
+}
+
+/**
+ * 화면에 표시되는 스펙트럼을 계산한 FFT 백엔드 이름 반환
+ * 스펙트럼 큐가 있으면 큐가 마지막으로 사용한 백엔드, 없으면 직접 분석기의 백엔드
+ * 반환값: 백엔드 이름 (아직 계산한 프레임이 없으면 빈 문자열)
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* getFFTBackendName() {
+    if (g_queue) {
+        return g_queue->backend_name();
+    }
+    if (!g_analyzer) {
+        return "";
+    }
+    return g_analyzer->backend_name();
+}
+
+/**
+ * 측정 결과(wisdom)를 텍스트로 내보내기 (localStorage 캐싱용)
+ * 반환값: 다음 exportFFTWisdom() 호출 전까지 유효한 문자열 포인터
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* exportFFTWisdom() {
+    static std::string wisdom;
+    wisdom = audio::FFTPlanner::global().export_wisdom();
+    return wisdom.c_str();
+}
+
+/**
+ * 캐시된 wisdom 불러오기 (다른 빌드 타깃의 wisdom은 거부)
+ * text: exportFFTWisdom()이 생성한 문자열
+ * 반환값: 성공 시 1, 실패 시 0
+ */
+EMSCRIPTEN_KEEPALIVE
+int importFFTWisdom(const char* text) {
+    if (!text || !audio::FFTPlanner::global().import_wisdom(text)) {
+        return 0;
+    }
+    if (g_analyzer) {
+        g_analyzer->replan();
+    }
+    if (g_queue) {
+        g_queue->replan();
+    }
+    return 1;
+}
+
 } // extern "C"
@@ -0,0 +1,461 @@
+#include "fft_backend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef AUDIO_HAS_DJ_FFT
+#include "dj_fft.h"
+#endif
+
+namespace audio {
+
+namespace {
+
+bool is_power_of_two(size_t n) { return n >= 2 && (n & (n - 1)) == 0; }
+
+// 2의 거듭제곱 n에 대한 정확한 log2 (std::log2 절삭 오차 방지)
+size_t exact_log2(size_t n) {
+  size_t log2n = 0;
+  while ((size_t{1} << log2n) < n) {
+    ++log2n;
+  }
+  return log2n;
+}
+
+size_t next_power_of_two(size_t n) {
+  size_t m = 1;
+  while (m < n) {
+    m <<= 1;
+  }
+  return m;
+}
+
+// 2, 3, 5 이외의 소인수가 없는지 검사
+bool is_smooth(size_t n) {
+  if (n < 2) {
+    return false;
+  }
+  for (size_t p : {2, 3, 5}) {
+    while (n % p == 0) {
+      n /= p;
+    }
+  }
+  return n == 1;
+}
+
+uint32_t reverse_bits(uint32_t x, size_t bits) {
+  uint32_t reversed = 0;
+  for (size_t j = 0; j < bits; ++j) {
+    reversed = (reversed << 1) | (x & 1);
+    x >>= 1;
+  }
+  return reversed;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// RadixTwoFFT: 기존 AudioAnalyzer의 Cooley-Tukey 구현
+// ---------------------------------------------------------------------------
+
+bool RadixTwoFFT::supports(size_t n) const { return is_power_of_two(n); }
+
+// Bit-reversal 테이블과 Twiddle factor 사전 계산
+void RadixTwoFFT::init(size_t n) {
+  const size_t log2n = exact_log2(n);
+
+  // Bit-reversal 테이블 계산
+  bit_reversed_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    bit_reversed_[i] = reverse_bits(static_cast<uint32_t>(i), log2n);
+  }
+
+  // Twiddle factors 사전 계산
+  // W_N^k = e^(-2πik/N) = cos(2πk/N) - i*sin(2πk/N)
+  twiddle_cos_.resize(n / 2);
+  twiddle_sin_.resize(n / 2);
+
+  for (size_t k = 0; k < n / 2; ++k) {
+    const float angle = -2.0f * M_PI * k / n;
+    twiddle_cos_[k] = std::cos(angle);
+    twiddle_sin_[k] = std::sin(angle);
+  }
+
+  scratch_.resize(n);
+}
+
+// Cooley-Tukey FFT 알고리즘 구현
+// 시간 복잡도: O(N log N)
+void RadixTwoFFT::forward(std::vector<std::complex<float>> &data) {
+  const size_t n = data.size();
+
+  // 1단계: Bit-reversal 순서로 입력 재배치 (scratch 버퍼 재사용)
+  for (size_t i = 0; i < n; ++i) {
+    scratch_[bit_reversed_[i]] = data[i];
+  }
+  data.swap(scratch_);
+
+  // 2단계: Butterfly 연산 수행 (log2(N) 스테이지)
+  for (size_t len = 2; len <= n; len *= 2) {
+    const size_t half_len = len / 2;
+    const size_t angle_step = n / len;
+
+    // 각 블록에 대해
+    for (size_t i = 0; i < n; i += len) {
+      // 블록 내의 각 쌍에 대해 butterfly 연산
+      for (size_t j = 0; j < half_len; ++j) {
+        const size_t k = i + j;
+        const size_t l = i + j + half_len;
+
+        // Twiddle factor
+        const size_t twiddle_idx = j * angle_step;
+        const float twiddle_real = twiddle_cos_[twiddle_idx];
+        const float twiddle_imag = twiddle_sin_[twiddle_idx];
+
+        // 복소수 곱셈: t = twiddle * data[l]
+        const float out_l_real = data[l].real();
+        const float out_l_imag = data[l].imag();
+
+        const float t_real =
+            twiddle_real * out_l_real - twiddle_imag * out_l_imag;
+        const float t_imag =
+            twiddle_real * out_l_imag + twiddle_imag * out_l_real;
+
+        // Butterfly 연산
+        const float out_k_real = data[k].real();
+        const float out_k_imag = data[k].imag();
+
+        data[k] = std::complex<float>(out_k_real + t_real, out_k_imag + t_imag);
+        data[l] = std::complex<float>(out_k_real - t_real, out_k_imag - t_imag);
+      }
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// ReferenceFFT: 테이블 없이 매번 twiddle을 계산하는 스칼라 기준 구현
+// ---------------------------------------------------------------------------
+
+bool ReferenceFFT::supports(size_t n) const { return is_power_of_two(n); }
+
+void ReferenceFFT::init(size_t n) { log2n_ = exact_log2(n); }
+
+void ReferenceFFT::forward(std::vector<std::complex<float>> &data) {
+  const size_t n = data.size();
+
+  for (size_t i = 0; i < n; ++i) {
+    const size_t j = reverse_bits(static_cast<uint32_t>(i), log2n_);
+    if (j > i) {
+      std::swap(data[i], data[j]);
+    }
+  }
+
+  for (size_t len = 2; len <= n; len *= 2) {
+    const size_t half_len = len / 2;
+    for (size_t i = 0; i < n; i += len) {
+      for (size_t j = 0; j < half_len; ++j) {
+        const double angle = -2.0 * M_PI * j / len;
+        const std::complex<float> w(static_cast<float>(std::cos(angle)),
+                                    static_cast<float>(std::sin(angle)));
+        const std::complex<float> t = w * data[i + j + half_len];
+        const std::complex<float> u = data[i + j];
+        data[i + j] = u + t;
+        data[i + j + half_len] = u - t;
+      }
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// MixedRadixFFT: 2^a * 3^b * 5^c 크기용 재귀 mixed-radix (decimation in time)
+// ---------------------------------------------------------------------------
+
+bool MixedRadixFFT::supports(size_t n) const { return is_smooth(n); }
+
+// 인수분해 (radix-4 우선, 그 다음 2, 3, 5)와 Twiddle factor 사전 계산
+void MixedRadixFFT::init(size_t n) {
+  n_ = n;
+  radices_.clear();
+  spans_.clear();
+
+  size_t remaining = n;
+  for (size_t p : {4, 2, 3, 5}) {
+    while (remaining % p == 0) {
+      remaining /= p;
+      radices_.push_back(p);
+      spans_.push_back(remaining);
+    }
+  }
+
+  // W_N^k = e^(-2πik/N), 정밀도를 위해 double로 계산
+  twiddles_.resize(n);
+  for (size_t k = 0; k < n; ++k) {
+    const double angle = -2.0 * M_PI * k / n;
+    twiddles_[k] = std::complex<float>(static_cast<float>(std::cos(angle)),
+                                       static_cast<float>(std::sin(angle)));
+  }
+
+  input_.resize(n);
+  scratch_.resize(5);
+}
+
+void MixedRadixFFT::forward(std::vector<std::complex<float>> &data) {
+  std::copy(data.begin(), data.end(), input_.begin());
+  work(data.data(), input_.data(), 1, 0);
+}
+
+// 한 단계: p개의 부분 변환(길이 m)을 재귀로 계산한 뒤 radix-p butterfly로 합침
+// fstride: 이 단계의 입력 간격이자 twiddle 인덱스 간격
+void MixedRadixFFT::work(std::complex<float> *out,
+                         const std::complex<float> *in, size_t fstride,
+                         size_t stage) {
+  const size_t p = radices_[stage];
+  const size_t m = spans_[stage];
+
+  if (m == 1) {
+    for (size_t j = 0; j < p; ++j) {
+      out[j] = in[j * fstride];
+    }
+  } else {
+    for (size_t j = 0; j < p; ++j) {
+      work(out + j * m, in + j * fstride, fstride * p, stage + 1);
+    }
+  }
+
+  switch (p) {
+  case 2:
+    butterfly2(out, fstride, m);
+    break;
+  case 3:
+    butterfly3(out, fstride, m);
+    break;
+  case 4:
+    butterfly4(out, fstride, m);
+    break;
+  default:
+    butterfly_generic(out, fstride, m, p);
+    break;
+  }
+}
+
+void MixedRadixFFT::butterfly2(std::complex<float> *out, size_t fstride,
+                               size_t m) {
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<float> t = out[k + m] * twiddles_[k * fstride];
+    out[k + m] = out[k] - t;
+    out[k] += t;
+  }
+}
+
+void MixedRadixFFT::butterfly3(std::complex<float> *out, size_t fstride,
+                               size_t m) {
+  // sin(-2π/3)
+  const float epi3_imag = twiddles_[fstride * m].imag();
+
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<float> s1 = out[k + m] * twiddles_[k * fstride];
+    const std::complex<float> s2 = out[k + 2 * m] * twiddles_[2 * k * fstride];
+    const std::complex<float> sum = s1 + s2;
+    const std::complex<float> diff = (s1 - s2) * epi3_imag;
+
+    const std::complex<float> mid = out[k] - sum * 0.5f;
+    out[k] += sum;
+    out[k + m] = std::complex<float>(mid.real() - diff.imag(),
+                                     mid.imag() + diff.real());
+    out[k + 2 * m] = std::complex<float>(mid.real() + diff.imag(),
+                                         mid.imag() - diff.real());
+  }
+}
+
+void MixedRadixFFT::butterfly4(std::complex<float> *out, size_t fstride,
+                               size_t m) {
+  for (size_t k = 0; k < m; ++k) {
+    const std::complex<float> s0 = out[k + m] * twiddles_[k * fstride];
+    const std::complex<float> s1 = out[k + 2 * m] * twiddles_[2 * k * fstride];
+    const std::complex<float> s2 = out[k + 3 * m] * twiddles_[3 * k * fstride];
+
+    const std::complex<float> s5 = out[k] - s1;
+    const std::complex<float> s4 = out[k] + s1;
+    const std::complex<float> s3 = s0 + s2;
+    const std::complex<float> s6 = s0 - s2;
+
+    out[k] = s4 + s3;
+    out[k + 2 * m] = s4 - s3;
+    // 순방향: -i * s6, +i * s6
+    out[k + m] = std::complex<float>(s5.real() + s6.imag(),
+                                     s5.imag() - s6.real());
+    out[k + 3 * m] = std::complex<float>(s5.real() - s6.imag(),
+                                         s5.imag() + s6.real());
+  }
+}
+
+// 임의 radix p (여기서는 5)에 대한 직접 DFT butterfly: O(p^2)
+void MixedRadixFFT::butterfly_generic(std::complex<float> *out, size_t fstride,
+                                      size_t m, size_t p) {
+  for (size_t u = 0; u < m; ++u) {
+    for (size_t q = 0; q < p; ++q) {
+      scratch_[q] = out[u + q * m];
+    }
+
+    for (size_t q1 = 0; q1 < p; ++q1) {
+      const size_t k = u + q1 * m;
+      size_t twiddle_idx = 0;
+      std::complex<float> acc = scratch_[0];
+      for (size_t q = 1; q < p; ++q) {
+        twiddle_idx += fstride * k;
+        if (twiddle_idx >= n_) {
+          twiddle_idx %= n_;
+        }
+        acc += scratch_[q] * twiddles_[twiddle_idx];
+      }
+      out[k] = acc;
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// BluesteinFFT: 임의 크기용 chirp-z 변환
+// X[k] = w[k] * Σ (x[j] w[j]) conj(w[k-j]),  w[k] = e^(-iπk²/N)
+// ---------------------------------------------------------------------------
+
+// 2의 거듭제곱은 radix-2 계열이 항상 더 빠르므로 제외
+bool BluesteinFFT::supports(size_t n) const {
+  return n >= 2 && !is_power_of_two(n);
+}
+
+void BluesteinFFT::init(size_t n) {
+  n_ = n;
+  const size_t m = next_power_of_two(2 * n - 1);
+  fft_.init(m);
+
+  // k²이 커지면 float 위상 오차가 커지므로 k² mod 2N으로 계산
+  // wasm32의 size_t는 32비트라 n > 65535에서 k²이 넘치므로 64비트로 계산
+  chirp_.resize(n);
+  const uint64_t period = 2 * static_cast<uint64_t>(n);
+  for (size_t k = 0; k < n; ++k) {
+    const uint64_t k2 = static_cast<uint64_t>(k) * k % period;
+    const double angle = -M_PI * k2 / n;
+    chirp_[k] = std::complex<float>(static_cast<float>(std::cos(angle)),
+                                    static_cast<float>(std::sin(angle)));
+  }
+
+  // 컨볼루션 커널 conj(w[k])를 순환 배치 (음수 인덱스는 뒤쪽)
+  kernel_spectrum_.assign(m, std::complex<float>(0.0f, 0.0f));
+  kernel_spectrum_[0] = std::conj(chirp_[0]);
+  for (size_t k = 1; k < n; ++k) {
+    kernel_spectrum_[k] = std::conj(chirp_[k]);
+    kernel_spectrum_[m - k] = std::conj(chirp_[k]);
+  }
+  fft_.forward(kernel_spectrum_);
+
+  // 역변환의 1/M 스케일을 커널 스펙트럼에 미리 반영
+  const float inv_m = 1.0f / static_cast<float>(m);
+  for (auto &value : kernel_spectrum_) {
+    value *= inv_m;
+  }
+
+  work_.resize(m);
+}
+
+void BluesteinFFT::forward(std::vector<std::complex<float>> &data) {
+  const size_t m = work_.size();
+
+  // a[k] = x[k] * w[k] (나머지는 0으로 패딩)
+  for (size_t k = 0; k < n_; ++k) {
+    work_[k] = data[k] * chirp_[k];
+  }
+  std::fill(work_.begin() + n_, work_.end(), std::complex<float>(0.0f, 0.0f));
+
+  // 주파수 영역 곱셈으로 컨볼루션, 역변환은 conj(FFT(conj(X)))로 계산
+  fft_.forward(work_);
+  for (size_t k = 0; k < m; ++k) {
+    work_[k] = std::conj(work_[k] * kernel_spectrum_[k]);
+  }
+  fft_.forward(work_);
+
+  for (size_t k = 0; k < n_; ++k) {
+    data[k] = std::conj(work_[k]) * chirp_[k];
+  }
+}
+
+// ---------------------------------------------------------------------------
+// DjFFT: dj_fft 서브모듈 래퍼
+// ---------------------------------------------------------------------------
+
+#ifdef AUDIO_HAS_DJ_FFT
+
+bool DjFFT::supports(size_t n) const { return is_power_of_two(n); }
+
+// dj_fft는 1/√N 정규화를 적용하므로 다른 커널과 스케일을 맞추기 위해
+// 임펄스 응답으로 스케일과 부호 규약을 한 번 측정한다
+void DjFFT::init(size_t n) {
+  dj::fft_arg<float> probe(n, std::complex<float>(0.0f, 0.0f));
+  probe[1] = std::complex<float>(1.0f, 0.0f);
+  dj::fft_arg<float> out = dj::fft1d(probe, dj::fft_dir::DIR_FWD);
+
+  // 기대값: X[1] = e^(-2πi/N), 허수부 음수
+  // 부호가 반대면 dj_fft의 역방향이 이 인터페이스의 정방향
+  // (출력만 켤레를 취하면 실수 입력에서만 맞고 복소 입력에서는 틀림)
+  inverse_ = n > 2 && out[1].imag() > 0.0f;
+  if (inverse_) {
+    out = dj::fft1d(probe, dj::fft_dir::DIR_BWD);
+  }
+
+  const float magnitude = std::abs(out[1]);
+  scale_ = magnitude > 0.0f ? 1.0f / magnitude : 1.0f;
+}
+
+// dj_fft에는 in-place API가 없어 fft1d가 호출마다 결과 벡터를 새로 할당함
+// (프레임당 힙 할당 1회, 측정 시간에도 포함됨)
+void DjFFT::forward(std::vector<std::complex<float>> &data) {
+  data = dj::fft1d(data, inverse_ ? dj::fft_dir::DIR_BWD
+                                  : dj::fft_dir::DIR_FWD);
+  for (auto &value : data) {
+    value *= scale_;
+  }
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+// 백엔드 레지스트리
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<FFTBackend> create_fft_backend(const char *name) {
+  if (!name) {
+    return nullptr;
+  }
+  if (std::strcmp(name, "radix2") == 0) {
+    return std::make_unique<RadixTwoFFT>();
+  }
+  if (std::strcmp(name, "reference") == 0) {
+    return std::make_unique<ReferenceFFT>();
+  }
+  if (std::strcmp(name, "mixed_radix") == 0) {
+    return std::make_unique<MixedRadixFFT>();
+  }
+  if (std::strcmp(name, "bluestein") == 0) {
+    return std::make_unique<BluesteinFFT>();
+  }
+#ifdef AUDIO_HAS_DJ_FFT
+  if (std::strcmp(name, "dj_fft") == 0) {
+    return std::make_unique<DjFFT>();
+  }
+#endif
+  return nullptr;
+}
+
+const std::vector<const char *> &fft_backend_names() {
+  static const std::vector<const char *> names = {
+      "radix2",
+      "reference",
+      "mixed_radix",
+      "bluestein",
+#ifdef AUDIO_HAS_DJ_FFT
+      "dj_fft",
+#endif
+  };
+  return names;
+}
+
+} // namespace audio
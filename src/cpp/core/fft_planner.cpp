@@ -0,0 +1,177 @@
+#include "fft_planner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <emscripten.h>
+
+namespace audio {
+
+namespace {
+
+constexpr const char *kWisdomMagic = "audio-fft-wisdom-v1";
+
+// 측정 파라미터
+// 브라우저의 performance.now()는 해상도가 5 µs ~ 1 ms로 거칠어서
+// FFT 1회(수십 µs)를 직접 재면 타이머 단위로 반올림됨
+// → 한 샘플이 kMinBatchMs 이상 걸리도록 반복 횟수를 늘려 배치 단위로 측정
+constexpr double kMinBatchMs = 1.0;
+constexpr int kMaxBatchRuns = 1 << 16;
+constexpr int kBatches = 5;
+
+// runs회 연속 실행한 전체 시간(ms)
+// 반복할수록 값이 커지지 않도록 매번 같은 입력에서 시작 (복사 비용은 모든 백엔드에 동일)
+double time_batch(FFTBackend &backend,
+                  const std::vector<std::complex<float>> &input,
+                  std::vector<std::complex<float>> &work, int runs) {
+  const double start = emscripten_get_now();
+  for (int run = 0; run < runs; ++run) {
+    std::copy(input.begin(), input.end(), work.begin());
+    backend.forward(work);
+  }
+  return emscripten_get_now() - start;
+}
+
+// 백엔드 하나를 n 크기로 측정하여 1회 실행당 시간(ms) 반환 (배치별 평균 중 최소값)
+double time_backend(FFTBackend &backend, size_t n) {
+  std::vector<std::complex<float>> input(n);
+  for (size_t i = 0; i < n; ++i) {
+    input[i] = std::complex<float>(std::sin(0.37f * i), 0.0f);
+  }
+  std::vector<std::complex<float>> work = input;
+
+  // 워밍업 (캐시, JIT tier-up) 겸 배치 크기 결정
+  int runs = 1;
+  while (time_batch(backend, input, work, runs) < kMinBatchMs &&
+         runs < kMaxBatchRuns) {
+    runs *= 2;
+  }
+
+  double best = std::numeric_limits<double>::infinity();
+  for (int batch = 0; batch < kBatches; ++batch) {
+    best = std::min(best, time_batch(backend, input, work, runs) / runs);
+  }
+  return best;
+}
+
+} // namespace
+
+FFTPlanner &FFTPlanner::global() {
+  static FFTPlanner planner;
+  return planner;
+}
+
+const char *FFTPlanner::target() {
+#if defined(__wasm_simd128__)
+  return "wasm32-simd128";
+#elif defined(__wasm__)
+  return "wasm32";
+#elif defined(__AVX2__)
+  return "native-avx2";
+#else
+  return "native";
+#endif
+}
+
+std::unique_ptr<FFTBackend> FFTPlanner::plan(size_t n) {
+  std::string name;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!forced_.empty()) {
+      auto forced = create_fft_backend(forced_.c_str());
+      if (forced && forced->supports(n)) {
+        forced->init(n);
+        return forced;
+      }
+    }
+    auto it = wisdom_.find(n);
+    if (it != wisdom_.end()) {
+      name = it->second;
+    }
+  }
+
+  if (name.empty()) {
+    name = measure(n);
+  }
+
+  auto backend = create_fft_backend(name.c_str());
+  if (!backend || !backend->supports(n)) {
+    // 잘못된 wisdom이면 다시 측정
+    name = measure(n);
+    backend = create_fft_backend(name.c_str());
+  }
+  if (backend) {
+    backend->init(n);
+  }
+  return backend;
+}
+
+std::string FFTPlanner::measure(size_t n) {
+  std::string best_name;
+  double best_ms = std::numeric_limits<double>::infinity();
+
+  for (const char *candidate : fft_backend_names()) {
+    auto backend = create_fft_backend(candidate);
+    if (!backend->supports(n)) {
+      continue;
+    }
+    backend->init(n);
+    const double ms = time_backend(*backend, n);
+    if (ms < best_ms) {
+      best_ms = ms;
+      best_name = candidate;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!best_name.empty()) {
+    wisdom_[n] = best_name;
+  }
+  return best_name;
+}
+
+bool FFTPlanner::force_backend(const std::string &name) {
+  if (!name.empty() && !create_fft_backend(name.c_str())) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  forced_ = name;
+  return true;
+}
+
+std::string FFTPlanner::export_wisdom() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream out;
+  out << kWisdomMagic << ' ' << target() << '\n';
+  for (const auto &[size, name] : wisdom_) {
+    out << size << ' ' << name << '\n';
+  }
+  return out.str();
+}
+
+bool FFTPlanner::import_wisdom(const std::string &text) {
+  std::istringstream in(text);
+  std::string magic, tag;
+  if (!(in >> magic >> tag) || magic != kWisdomMagic || tag != target()) {
+    return false;
+  }
+
+  std::map<size_t, std::string> parsed;
+  size_t size = 0;
+  std::string name;
+  while (in >> size >> name) {
+    // 이 빌드에 없는 백엔드는 무시 (다음 plan()에서 재측정)
+    auto backend = create_fft_backend(name.c_str());
+    if (backend && backend->supports(size)) {
+      parsed[size] = name;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &[s, n] : parsed) {
+    wisdom_[s] = std::move(n);
+  }
+  return true;
+}
+
+} // namespace audio
@@ -0,0 +1,270 @@
+#include "spectrum_queue.h"
+#include <algorithm>
+#include <emscripten.h>
+
+namespace audio {
+
+// 스펙트럼 큐 생성자
+// samples: 분석할 PCM 샘플 (큐보다 오래 살아 있어야 함)
+// capacity: 미리 계산해 둘 프레임 수 (링 크기)
+SpectrumQueue::SpectrumQueue(const float *samples, size_t num_samples,
+                             size_t capacity)
+    : samples_(samples), num_samples_(num_samples),
+      capacity_(std::max<size_t>(capacity, 2)), ring_(capacity_) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+  worker_ = std::thread(&SpectrumQueue::worker_loop, this);
+#endif
+}
+
+SpectrumQueue::~SpectrumQueue() {
+#ifdef __EMSCRIPTEN_PTHREADS__
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  worker_.join();
+#endif
+}
+
+// FFT 크기/홉 변경: 큐에 있던 프레임은 모두 무효화
+void SpectrumQueue::configure(size_t fft_size, size_t hop) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fft_size == fft_size_ && hop == hop_) {
+      return;
+    }
+
+    fft_size_ = fft_size;
+    hop_ = std::max<size_t>(hop, 1);
+    ++generation_; // 계산 중이던 프레임은 commit 시 버려짐
+
+    for (auto &frame : ring_) {
+      frame.index = -1;
+      frame.magnitude.assign(fft_size / 2, 0.0f);
+    }
+    playhead_ = 0;
+    next_ = 0;
+  }
+  work_cv_.notify_all();
+}
+
+// 재생 위치 점프: 새 위치부터 다시 미리 계산
+// 슬롯마다 프레임 번호를 들고 있으므로 새 범위 안의 프레임은 그대로 재사용
+// (같은 위치에서 재개하면 링 전체가 유지됨)
+void SpectrumQueue::seek(size_t sample_offset) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hop_ == 0) {
+      return;
+    }
+    const int64_t k = static_cast<int64_t>(sample_offset / hop_);
+    if (k == playhead_) {
+      return;
+    }
+    playhead_ = k;
+    next_ = k; // 이미 채워진 프레임은 claim_job에서 건너뜀
+  }
+  work_cv_.notify_all();
+}
+
+// FFT 백엔드 재선택: 분석기는 각자 사용하는 스레드에서 다음 프레임 전에 replan
+void SpectrumQueue::replan() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_; // 이전 백엔드로 계산 중이던 프레임은 commit 시 버려짐
+    for (auto &frame : ring_) {
+      frame.index = -1;
+    }
+    next_ = playhead_;
+    producer_replan_ = true;
+    sync_replan_ = true;
+  }
+  work_cv_.notify_all();
+}
+
+const char *SpectrumQueue::backend_name() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return backend_name_;
+}
+
+// 현재 재생 위치에 해당하는 프레임 반환
+// 미리 계산된 프레임이 있으면 그대로 반환하고, 없으면 즉시 계산
+const float *SpectrumQueue::fetch(size_t sample_offset) {
+  Job job;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fft_size_ == 0) {
+      return nullptr;
+    }
+
+    const int64_t k = static_cast<int64_t>(sample_offset / hop_);
+    if (k != playhead_) {
+      if (!frame_in_range(k)) {
+        // 링 범위를 벗어난 점프 (탐색/되감기): 생산 위치를 재설정
+        next_ = k;
+      }
+      playhead_ = k;
+      next_ = std::max(next_, k);
+      work_cv_.notify_all();
+    }
+
+    if (!frame_in_audio(k)) {
+      return nullptr; // FFT에 필요한 샘플이 부족
+    }
+
+    Frame &frame = ring_[k % capacity_];
+    if (frame.index == k) {
+      ++hits_;
+      return frame.magnitude.data();
+    }
+
+    ++misses_;
+    job = {k, generation_, fft_size_, hop_, sync_replan_};
+    sync_replan_ = false;
+  }
+
+  // 아직 준비되지 않은 프레임은 렌더 스레드에서 직접 계산
+  if (!sync_analyzer_) {
+    sync_analyzer_ = std::make_unique<AudioAnalyzer>(job.fft_size);
+  }
+  commit(job, compute(*sync_analyzer_, job), sync_analyzer_->backend_name());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  next_ = std::max(next_, job.index + 1);
+  return ring_[job.index % capacity_].magnitude.data();
+}
+
+// 이미 링에 준비된 프레임만 반환 (동기 계산 없음, 재생 위치 유지)
+// 재생 범위 안의 슬롯은 같은 프레임으로만 채워지므로 재생 위치가 움직이기 전까지 유효
+const float *SpectrumQueue::peek(size_t sample_offset) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fft_size_ == 0) {
+    return nullptr;
+  }
+  const int64_t k = static_cast<int64_t>(sample_offset / hop_);
+  if (!frame_in_range(k)) {
+    return nullptr;
+  }
+  const Frame &frame = ring_[k % capacity_];
+  return frame.index == k ? frame.magnitude.data() : nullptr;
+}
+
+// 유휴 시간에 프레임을 미리 계산 (pthread 빌드에서는 워커 스레드가 담당)
+size_t SpectrumQueue::pump(double budget_ms) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+  (void)budget_ms;
+  return 0;
+#else
+  const double start = emscripten_get_now();
+  size_t produced = 0;
+
+  while (emscripten_get_now() - start < budget_ms) {
+    Job job;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!claim_job(job)) {
+        break;
+      }
+    }
+
+    if (!producer_analyzer_) {
+      producer_analyzer_ = std::make_unique<AudioAnalyzer>(job.fft_size);
+    }
+    commit(job, compute(*producer_analyzer_, job),
+           producer_analyzer_->backend_name());
+    ++produced;
+  }
+
+  return produced;
+#endif
+}
+
+// 재생 위치 이후로 준비된 프레임 수
+size_t SpectrumQueue::depth() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t ready = 0;
+  for (int64_t k = playhead_; k < next_; ++k) {
+    if (ring_[k % capacity_].index == k) {
+      ++ready;
+    }
+  }
+  return ready;
+}
+
+bool SpectrumQueue::claim_job(Job &job) {
+  if (fft_size_ == 0) {
+    return false;
+  }
+  while (frame_in_range(next_) && ring_[next_ % capacity_].index == next_) {
+    ++next_;
+  }
+  if (!frame_in_range(next_) || !frame_in_audio(next_)) {
+    return false;
+  }
+  job = {next_, generation_, fft_size_, hop_, producer_replan_};
+  producer_replan_ = false;
+  ++next_;
+  return true;
+}
+
+const float *SpectrumQueue::compute(AudioAnalyzer &analyzer,
+                                    const Job &job) const {
+  // 분석기 크기는 해당 분석기를 쓰는 스레드에서만 변경
+  analyzer.set_fft_size(job.fft_size);
+  if (job.replan) {
+    analyzer.replan();
+  }
+  const size_t offset = static_cast<size_t>(job.index) * job.hop;
+  return analyzer.analyze(samples_ + offset, num_samples_ - offset);
+}
+
+void SpectrumQueue::commit(const Job &job, const float *magnitude,
+                           const char *backend) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 설정이 바뀌었거나 이미 지나간 프레임이면 버림
+  if (job.generation != generation_ || !frame_in_range(job.index)) {
+    return;
+  }
+  backend_name_ = backend; // 백엔드 이름은 문자열 리터럴이라 분석기보다 오래 유효
+  // 렌더 스레드가 읽고 있을 수 있으므로 이미 채워진 프레임은 덮어쓰지 않음
+  Frame &frame = ring_[job.index % capacity_];
+  if (frame.index == job.index) {
+    return;
+  }
+  std::copy(magnitude, magnitude + fft_size_ / 2, frame.magnitude.begin());
+  frame.index = job.index;
+}
+
+bool SpectrumQueue::frame_in_range(int64_t index) const {
+  return index >= playhead_ &&
+         index < playhead_ + static_cast<int64_t>(capacity_);
+}
+
+bool SpectrumQueue::frame_in_audio(int64_t index) const {
+  return static_cast<size_t>(index) * hop_ + fft_size_ <= num_samples_;
+}
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+// 워커 스레드: 링에 빈 자리가 생길 때마다 다음 프레임을 계산
+void SpectrumQueue::worker_loop() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock, [&] { return stop_ || claim_job(job); });
+      if (stop_) {
+        return;
+      }
+    }
+
+    if (!producer_analyzer_) {
+      producer_analyzer_ = std::make_unique<AudioAnalyzer>(job.fft_size);
+    }
+    commit(job, compute(*producer_analyzer_, job),
+           producer_analyzer_->backend_name());
+  }
+}
+#endif
+
+} // namespace audio
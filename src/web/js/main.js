@@ -3,6 +3,7 @@ import { AudioPlayer } from "./audio-player.js";
 import { Visualizer3D } from "./visualizer-3d.js";
 import { UIControls } from "./ui-controls.js";
 import { PerformanceMonitor } from "./performance-monitor.js";
+import { SpectrogramView } from "./spectrogram-view.js";
 
 class App {
   constructor() {
@@ -11,6 +12,7 @@ class App {
     this.visualizer = null;
     this.uiControls = null;
     this.performanceMonitor = null;
+    this.spectrogramView = null;
     this.audioData = null;
 
     // 성능 최적화: 사전 할당 버퍼 (zero-copy 설계)
@@ -18,14 +20,30 @@ class App {
     this.avgMagnitudesBuffer = null;
     this.currentFFTSize = 0;
 
+    // 분석 FFT 크기 (2의 거듭제곱이 아니어도 됨: mixed-radix/Bluestein)
+    this.fftSize = 2048;
+    // 0이 아니면 영상 프레임 단위 분석: 창 크기 = 홉 = 샘플레이트 / fps
+    // (48 kHz에서 30 fps = 1600, 44.1 kHz에서 1470)
+    this.fftFrameRate = 0;
+
     // FFT 데이터 스무딩을 위한 버퍼
     this.smoothedFrequencyData = null;
     this.smoothingFactor = 0.7; // 0.7 = 70% 이전 값, 30% 새 값 (부드러운 전환)
     this.smoothedMaxMagnitude = 1.0; // 스무딩된 최대 크기 (정규화용)
 
-    // 레이턴시 보정을 위한 변수
-    this.lookAheadMs = 15; // 미래 시점 예측 (ms) - 동적으로 조정됨
-    this.lastFFTDuration = 0; // 마지막 FFT 계산 시간
+    // 스펙트럼 큐: C++ 쪽에서 재생 위치보다 앞서 프레임을 미리 계산
+    this.queueHopSamples = 0; // 큐 프레임 간격 (샘플)
+    this.queueIdleHandle = null;
+
+    // 스펙트로그램: WASM 링 텍스처에 큐 프레임마다 열 하나씩 기록
+    this.spectrogramHistory = 512; // 보관할 열 개수
+    this.spectrogramBins = 0;
+    this.lastSpectrogramFrame = -1;
+    this.spectrogramDirty = false;
+
+    // FFT 백엔드 표시 (강제 지정 백엔드와 실제 사용 중인 백엔드)
+    this.forcedFFTBackend = "";
+    this.fftBackendLabelState = { ptr: -1, size: 0, forced: "" };
 
     // 조회 오버헤드 방지를 위한 WASM 함수 참조 캐싱
     this.wasmFunctions = {
@@ -36,7 +54,20 @@ class App {
       loadAudio: null,
       getBatchFFTData: null,
       getFFTDataAtOffset: null,
+      configureSpectrumQueue: null,
+      getQueuedFFTData: null,
+      seekSpectrumQueue: null,
+      pumpSpectrumQueue: null,
+      createSpectrogram: null,
+      setSpectrogramRange: null,
+      pushSpectrogramColumn: null,
+      pushSpectrogramBlank: null,
+      peekQueuedFFTData: null,
+      getSpectrogramPixels: null,
+      getSpectrogramWriteIndex: null,
       getLastFFTTime: null,
+      getFFTBackendName: null,
+      tuneFFT: null,
       malloc: null,
       free: null,
     };
@@ -55,10 +86,15 @@ class App {
       // 성능을 위한 WASM 함수 참조 캐싱
       this.cacheWasmFunctions();
 
+      // FFT 백엔드 자동 튜닝 (캐시된 wisdom이 있으면 측정 생략)
+      await this.autoTuneFFT();
+
       // 컴포넌트 초기화
       this.audioPlayer = new AudioPlayer();
       this.visualizer = new Visualizer3D("canvas-container");
+      this.spectrogramView = new SpectrogramView("canvas-container");
       this.uiControls = new UIControls(this);
+      this.populateFFTBackends();
       this.performanceMonitor = new PerformanceMonitor();
 
       // 이벤트 리스너 설정
@@ -82,11 +118,159 @@ class App {
     this.wasmFunctions.loadAudio = this.wasmModule._loadAudio;
     this.wasmFunctions.getBatchFFTData = this.wasmModule._getBatchFFTData;
     this.wasmFunctions.getFFTDataAtOffset = this.wasmModule._getFFTDataAtOffset;
+    this.wasmFunctions.configureSpectrumQueue =
+      this.wasmModule._configureSpectrumQueue;
+    this.wasmFunctions.getQueuedFFTData = this.wasmModule._getQueuedFFTData;
+    this.wasmFunctions.seekSpectrumQueue = this.wasmModule._seekSpectrumQueue;
+    this.wasmFunctions.pumpSpectrumQueue = this.wasmModule._pumpSpectrumQueue;
+    this.wasmFunctions.createSpectrogram = this.wasmModule._createSpectrogram;
+    this.wasmFunctions.setSpectrogramRange =
+      this.wasmModule._setSpectrogramRange;
+    this.wasmFunctions.pushSpectrogramColumn =
+      this.wasmModule._pushSpectrogramColumn;
+    this.wasmFunctions.pushSpectrogramBlank =
+      this.wasmModule._pushSpectrogramBlank;
+    this.wasmFunctions.peekQueuedFFTData = this.wasmModule._peekQueuedFFTData;
+    this.wasmFunctions.getSpectrogramPixels =
+      this.wasmModule._getSpectrogramPixels;
+    this.wasmFunctions.getSpectrogramWriteIndex =
+      this.wasmModule._getSpectrogramWriteIndex;
     this.wasmFunctions.getLastFFTTime = this.wasmModule._getLastFFTTime;
+    this.wasmFunctions.getFFTBackendName = this.wasmModule._getFFTBackendName;
+    this.wasmFunctions.tuneFFT = this.wasmModule._tuneFFT;
     this.wasmFunctions.malloc = this.wasmModule._malloc;
     this.wasmFunctions.free = this.wasmModule._free;
   }
 
+  async autoTuneFFT() {
+    const WISDOM_KEY = "fft-wisdom";
+    const ccall = this.wasmModule.ccall;
+
+    // 다른 빌드 타깃의 wisdom이면 import가 실패하므로 전부 다시 측정
+    const cached = localStorage.getItem(WISDOM_KEY);
+    if (cached) {
+      ccall("importFFTWisdom", "number", ["string"], [cached]);
+    }
+
+    // 측정된 크기는 import 후의 wisdom에서 읽음
+    // (이 빌드에 없는 백엔드 항목은 import에서 버려지므로 해당 크기는 다시 측정)
+    const wisdom = ccall("exportFFTWisdom", "string", [], [])
+      .split("\n")
+      .slice(1);
+    const tunedSizes = new Set(wisdom.map((line) => parseInt(line)));
+
+    // UI에서 선택 가능한 FFT 크기마다 한 번씩 측정 (wisdom에 있으면 건너뜀)
+    // 프레임 고정 항목은 흔한 샘플레이트(44.1/48 kHz)에서의 창 크기도 측정
+    const sizes = new Set();
+    for (const option of document.querySelectorAll("#fft-size option")) {
+      const frameRate = parseInt(option.dataset.fps);
+      if (frameRate) {
+        for (const rate of [44100, 48000]) {
+          sizes.add(Math.round(rate / frameRate));
+        }
+      } else {
+        sizes.add(parseInt(option.value));
+      }
+    }
+    for (const size of tunedSizes) {
+      sizes.delete(size);
+    }
+    if (sizes.size === 0) return;
+
+    // 측정은 동기 작업이므로 상태 메시지가 먼저 그려지도록 한 프레임 양보
+    this.updateStatus("FFT 백엔드 튜닝 중...");
+    await new Promise((resolve) =>
+      requestAnimationFrame(() => setTimeout(resolve, 0))
+    );
+
+    for (const size of sizes) {
+      this.wasmFunctions.tuneFFT(size);
+    }
+
+    const exported = ccall("exportFFTWisdom", "string", [], []);
+    localStorage.setItem(WISDOM_KEY, exported);
+    console.log("FFT wisdom:\n" + exported);
+  }
+
+  // frameRate: 0이면 size를 그대로 사용, 아니면 오디오 샘플레이트에서 창 크기를 계산
+  //            (size는 파일이 로드되기 전까지 쓰는 48 kHz 기준 값)
+  setFFTSize(size, frameRate = 0) {
+    this.fftSize = size;
+    this.fftFrameRate = frameRate;
+
+    // AnalyserNode는 2의 거듭제곱만 허용
+    const analyser = this.audioPlayer && this.audioPlayer.analyser;
+    if (analyser && (size & (size - 1)) === 0) {
+      analyser.fftSize = size;
+      this.audioPlayer.frequencyData = new Uint8Array(
+        analyser.frequencyBinCount
+      );
+    }
+    console.log(`FFT size changed to: ${size}`);
+  }
+
+  setFFTBackend(name) {
+    if (!this.wasmModule) return;
+    const ok = this.wasmModule.ccall(
+      "setFFTBackend",
+      "number",
+      ["string"],
+      [name]
+    );
+    if (ok) {
+      this.forcedFFTBackend = name;
+      console.log(`FFT 백엔드: ${name || "auto"}`);
+    } else {
+      this.forcedFFTBackend = "";
+      console.warn(`이 빌드에 없는 FFT 백엔드: ${name}`);
+      // 선택 상자가 실제로 쓰이지 않는 백엔드를 가리키지 않도록 자동으로 되돌림
+      document.getElementById("fft-backend").value = "";
+    }
+  }
+
+  // 실제로 스펙트럼을 계산 중인 백엔드를 성능 패널에 표시
+  // 강제 지정한 백엔드가 현재 크기를 지원하지 않으면 플래너가 측정 결과로 대체하므로 함께 표시
+  updateFFTBackendLabel() {
+    // 백엔드 이름은 C++ 문자열 리터럴이라 포인터가 같으면 이름도 같음
+    const ptr = this.wasmFunctions.getFFTBackendName();
+    const forced = this.forcedFFTBackend;
+    const state = this.fftBackendLabelState;
+    if (
+      state.ptr === ptr &&
+      state.size === this.fftSize &&
+      state.forced === forced
+    ) {
+      return;
+    }
+    state.ptr = ptr;
+    state.size = this.fftSize;
+    state.forced = forced;
+
+    const active = (ptr && this.wasmModule.UTF8ToString(ptr)) || "-";
+    const label =
+      forced && active !== "-" && active !== forced
+        ? `${active} (${forced} unsupported at ${this.fftSize})`
+        : active;
+    this.performanceMonitor.setFFTBackend(label);
+  }
+
+  // 이 빌드에 컴파일되지 않은 백엔드(예: 서브모듈 없는 dj_fft)는 선택지에서 제거
+  populateFFTBackends() {
+    const select = document.getElementById("fft-backend");
+    if (!select) return;
+
+    const available = new Set(
+      this.wasmModule
+        .ccall("getFFTBackendNames", "string", [], [])
+        .split(",")
+    );
+    for (const option of Array.from(select.options)) {
+      if (option.value && !available.has(option.value)) {
+        option.remove();
+      }
+    }
+  }
+
   setupEventListeners() {
     // 파일 입력
     const fileInput = document.getElementById("audio-file");
@@ -168,6 +352,9 @@ class App {
       // 재생을 위해 Web Audio API에 오디오 로드
       await this.audioPlayer.loadFromAudioBuffer(audioBuffer);
 
+      // 새 오디오는 새 스펙트럼 큐를 사용 (loadAudio가 이전 큐를 정리함)
+      this.currentFFTSize = 0;
+
       // 컨트롤 활성화
       document.getElementById("play-pause-btn").disabled = false;
       document.getElementById("stop-btn").disabled = false;
@@ -233,6 +420,8 @@ class App {
       playPauseBtn.textContent = "▶ 재생";
     } else {
       this.audioPlayer.play();
+      this.seekSpectrumQueue();
+      this.scheduleQueuePump();
       this.updateStatus("재생 중...");
       this.performanceMonitor.start();
       playPauseBtn.textContent = "⏸ 일시정지";
@@ -242,6 +431,7 @@ class App {
   stop() {
     if (this.audioPlayer) {
       this.audioPlayer.stop();
+      this.seekSpectrumQueue();
       this.updateStatus("정지");
       this.performanceMonitor.stop();
 
@@ -250,6 +440,37 @@ class App {
     }
   }
 
+  // 재생 위치가 점프했음을 큐에 알림 (해당 위치부터 다시 미리 계산)
+  seekSpectrumQueue() {
+    if (!this.queueHopSamples) return;
+    const sampleRate = this.wasmFunctions.getSampleRate();
+    const offset = Math.floor(this.audioPlayer.getCurrentTime() * sampleRate);
+    this.wasmFunctions.seekSpectrumQueue(offset);
+  }
+
+  // 유휴 시간에 다음 스펙트럼 프레임을 미리 계산 (pthread 빌드에서는 no-op)
+  scheduleQueuePump() {
+    if (this.queueIdleHandle !== null) return;
+
+    const requestIdle =
+      window.requestIdleCallback ||
+      ((cb) => setTimeout(() => cb({ timeRemaining: () => 4 }), 0));
+
+    const pump = (deadline) => {
+      this.queueIdleHandle = null;
+      if (!this.audioPlayer || !this.audioPlayer.isPlaying()) return;
+
+      // 다음 프레임 렌더링을 방해하지 않도록 남은 유휴 시간의 일부만 사용
+      const budget = Math.min(deadline.timeRemaining() - 1, 8);
+      if (budget > 0) {
+        this.wasmFunctions.pumpSpectrumQueue(budget);
+      }
+      this.queueIdleHandle = requestIdle(pump);
+    };
+
+    this.queueIdleHandle = requestIdle(pump);
+  }
+
   animate = () => {
     requestAnimationFrame(this.animate);
 
@@ -268,11 +489,15 @@ class App {
       const wasmFrequencyData = this.getWasmFrequencyData();
 
       this.performanceMonitor.endFFT();
+      this.updateFFTBackendLabel();
 
       if (wasmFrequencyData && this.visualizer) {
         const sampleRate = this.wasmFunctions.getSampleRate();
-        const fftSize = this.audioPlayer?.analyser?.fftSize || 2048;
-        this.visualizer.updateFrequency(wasmFrequencyData, sampleRate, fftSize);
+        this.visualizer.updateFrequency(
+          wasmFrequencyData,
+          sampleRate,
+          this.fftSize
+        );
       }
     }
 
@@ -282,33 +507,43 @@ class App {
   getWasmFrequencyData() {
     if (!this.wasmModule || !this.audioPlayer) return null;
 
-    const fftStartTime = performance.now();
-
     // 현재 재생 시간을 샘플 오프셋으로 변환 (캐시된 함수 사용)
     const currentTime = this.audioPlayer.getCurrentTime();
     const sampleRate = this.wasmFunctions.getSampleRate();
     const sampleOffset = Math.floor(currentTime * sampleRate);
 
-    // analyser에서 FFT 크기 가져오기 (또는 기본값 사용)
-    const fftSize = this.audioPlayer.analyser
-      ? this.audioPlayer.analyser.fftSize
-      : 2048;
-    const numBins = fftSize / 2;
+    // 프레임 고정 모드: 샘플레이트마다 영상 한 프레임 길이로 창 크기 결정
+    if (this.fftFrameRate && sampleRate) {
+      this.fftSize = Math.round(sampleRate / this.fftFrameRate);
+    }
+    const fftSize = this.fftSize;
+    const numBins = Math.floor(fftSize / 2);
 
-    // FFT 크기가 변경된 경우에만 버퍼 재할당 (zero-copy 최적화)
+    // FFT 크기가 변경된 경우에만 버퍼 재할당 및 큐 재설정 (zero-copy 최적화)
     if (this.currentFFTSize !== fftSize) {
       this.currentFFTSize = fftSize;
       this.wasmFrequencyData = new Uint8Array(numBins);
       this.avgMagnitudesBuffer = new Float32Array(numBins);
       this.smoothedFrequencyData = new Uint8Array(numBins);
+
+      // 큐 프레임 간격: 프레임 고정 크기면 창 크기 그대로 (겹침 없음),
+      // 아니면 60 FPS 기준 한 화면 프레임 분량의 샘플
+      this.queueHopSamples = this.fftFrameRate
+        ? fftSize
+        : Math.max(1, Math.round(sampleRate / 60));
+      this.wasmFunctions.configureSpectrumQueue(fftSize, this.queueHopSamples);
     }
 
-    // 단일 프레임 WASM FFT 함수 호출 (캐시된 함수 사용)
-    const fftPtr = this.wasmFunctions.getFFTDataAtOffset(sampleOffset, fftSize);
+    // 건너뛴 프레임은 현재 프레임을 가져오기 전에 채움 (재생 위치가 움직이면 링 슬롯이 재사용됨)
+    const spectrogramDue = this.catchUpSpectrogram(sampleOffset, fftSize);
+
+    // 큐에서 현재 시점의 프레임 가져오기 (대부분 미리 계산되어 있음)
+    const fftPtr = this.wasmFunctions.getQueuedFFTData(sampleOffset);
+    this.updateSpectrogram(spectrogramDue ? fftPtr : 0);
 
     if (!fftPtr) {
-      // WASM FFT 실패 시 Web Audio API로 폴백
-      return this.audioPlayer.getFrequencyData();
+      // 오디오 끝 부근: 마지막 프레임 유지
+      return this.smoothedFrequencyData;
     }
 
     // 순수 FFT 연산 시간 가져오기 (함수 호출 오버헤드 제외)
@@ -359,15 +594,91 @@ class App {
       );
     }
 
-    // FFT 계산 시간 측정 및 동적 look-ahead 조정
-    const fftEndTime = performance.now();
-    this.lastFFTDuration = fftEndTime - fftStartTime;
+    return this.smoothedFrequencyData;
+  }
 
-    // 동적 look-ahead: FFT 시간의 2배 + 여유분 (exponential smoothing)
-    const targetLookAhead = Math.max(10, this.lastFFTDuration * 2 + 5);
-    this.lookAheadMs = this.lookAheadMs * 0.8 + targetLookAhead * 0.2;
+  setSpectrogramEnabled(enabled) {
+    if (!this.spectrogramView) return;
+    this.spectrogramView.setVisible(enabled);
+    this.lastSpectrogramFrame = -1;
+  }
 
-    return this.smoothedFrequencyData;
+  // 큐 프레임 하나당 열 하나를 기록해 시간축을 균일하게 유지
+  // 렌더가 밀려 건너뛴 프레임은 큐에 이미 준비된 것만 기록하고 (동기 FFT 없음),
+  // 준비되지 않은 구간은 빈 열로 채움 → 프레임당 비용이 공백 길이에 비례해 늘지 않음
+  // 반환값: 현재 프레임의 열을 기록해야 하면 true
+  catchUpSpectrogram(sampleOffset, fftSize) {
+    if (!this.spectrogramView || !this.spectrogramView.isVisible()) {
+      return false;
+    }
+
+    const numBins = Math.floor(fftSize / 2);
+    if (this.spectrogramBins !== numBins) {
+      this.spectrogramBins = numBins;
+      this.lastSpectrogramFrame = -1;
+      this.wasmFunctions.createSpectrogram(numBins, this.spectrogramHistory, 0);
+      // 0 dB = Hann 윈도우를 거친 풀스케일 사인파의 크기 (fftSize / 4)
+      this.wasmFunctions.setSpectrogramRange(-90, 0, fftSize / 4);
+      this.spectrogramView.resize(numBins, this.spectrogramHistory);
+    }
+
+    const hop = this.queueHopSamples;
+    const frame = Math.floor(sampleOffset / hop);
+    const last = this.lastSpectrogramFrame;
+    if (frame === last) return false;
+    this.lastSpectrogramFrame = frame;
+
+    // 처음이거나 되감기/정지 후에는 현재 프레임부터 다시 시작
+    if (last < 0 || frame < last) return true;
+
+    // 큐는 재생 위치부터 순서대로 채우므로 준비된 프레임은 링 크기 이하의 연속 구간
+    // 첫 미준비 프레임부터 현재 프레임 직전까지는 빈 열로 처리
+    const pixels = this.wasmFunctions.getSpectrogramPixels();
+    let f = last + 1;
+    for (; f < frame; f++) {
+      const fftPtr = this.wasmFunctions.peekQueuedFFTData(f * hop);
+      if (!fftPtr) break;
+      const column = this.wasmFunctions.pushSpectrogramColumn(fftPtr);
+      this.spectrogramView.uploadColumn(this.wasmModule.HEAPU8, pixels, column);
+      this.spectrogramDirty = true;
+    }
+    this.pushSpectrogramBlank(pixels, frame - f);
+    return true;
+  }
+
+  pushSpectrogramBlank(pixels, count) {
+    count = Math.min(count, this.spectrogramHistory);
+    if (count <= 0) return;
+    const column = this.wasmFunctions.pushSpectrogramBlank(count);
+    this.spectrogramView.fillColumns(
+      this.wasmModule.HEAPU8,
+      pixels,
+      column,
+      count
+    );
+    this.spectrogramDirty = true;
+  }
+
+  // 현재 프레임의 열을 기록하고, 바뀐 내용이 있으면 링을 한 번만 그림
+  updateSpectrogram(fftPtr) {
+    if (fftPtr) {
+      const column = this.wasmFunctions.pushSpectrogramColumn(fftPtr);
+      if (column >= 0) {
+        this.spectrogramView.uploadColumn(
+          this.wasmModule.HEAPU8,
+          this.wasmFunctions.getSpectrogramPixels(),
+          column
+        );
+        this.spectrogramDirty = true;
+      }
+    }
+
+    if (this.spectrogramDirty) {
+      this.spectrogramDirty = false;
+      this.spectrogramView.present(
+        this.wasmFunctions.getSpectrogramWriteIndex()
+      );
+    }
   }
 
   updateStatus(message) {
@@ -24,6 +24,9 @@ export class PerformanceMonitor {
         this.pureWasmFftTimes = [];
         this.avgPureWasmFftTime = 0;
 
+        // FFT backend actually producing the spectrum
+        this.fftBackend = '-';
+
         // Memory tracking
         this.memoryCheckInterval = 1000; // Check every second
         this.lastMemoryCheck = 0;
@@ -43,6 +46,7 @@ export class PerformanceMonitor {
         this.fftTimeElement = document.getElementById('fft-time-value');
         this.pureWasmFftTimeElement = document.getElementById('pure-wasm-fft-time-value');
         this.memoryElement = document.getElementById('memory-value');
+        this.fftBackendElement = document.getElementById('fft-backend-value');
     }
 
     start() {
@@ -139,6 +143,10 @@ export class PerformanceMonitor {
         this.avgPureWasmFftTime = this.pureWasmFftTimes.reduce((a, b) => a + b, 0) / this.pureWasmFftTimes.length;
     }
 
+    setFFTBackend(label) {
+        this.fftBackend = label;
+    }
+
     checkMemory() {
         if (performance.memory) {
             this.currentMemory = performance.memory.usedJSHeapSize / 1048576; // Convert to MB
@@ -162,6 +170,10 @@ export class PerformanceMonitor {
             this.pureWasmFftTimeElement.textContent = this.avgPureWasmFftTime.toFixed(4) + ' ms';
         }
 
+        if (this.fftBackendElement) {
+            this.fftBackendElement.textContent = this.fftBackend;
+        }
+
         if (this.memoryElement) {
             this.memoryElement.textContent = this.currentMemory.toFixed(2) + ' MB';
         }
@@ -0,0 +1,106 @@
+// 스크롤 스펙트로그램(waterfall) 뷰
+// 이미지는 WASM 메모리의 Spectrogram 링 텍스처에 있으며,
+// 매 프레임 새로 기록된 열 하나만 캔버스로 옮긴다 (히스토리 길이와 무관한 비용)
+export class SpectrogramView {
+  constructor(containerId) {
+    this.container = document.getElementById(containerId);
+    this.numBins = 0;
+    this.history = 0;
+
+    // 링 텍스처와 같은 배치의 오프스크린 캔버스 (x = 열, y = 주파수 빈)
+    this.ringCanvas = document.createElement("canvas");
+    this.ringContext = this.ringCanvas.getContext("2d");
+    this.columnImage = null;
+
+    // 화면에 보이는 캔버스 (가장 오래된 열이 왼쪽)
+    this.canvas = document.createElement("canvas");
+    this.canvas.id = "spectrogram";
+    this.canvas.style.display = "none";
+    this.context = this.canvas.getContext("2d");
+    this.container.appendChild(this.canvas);
+
+    this.onWindowResize();
+    window.addEventListener("resize", () => this.onWindowResize());
+  }
+
+  setVisible(visible) {
+    this.canvas.style.display = visible ? "block" : "none";
+  }
+
+  isVisible() {
+    return this.canvas.style.display !== "none";
+  }
+
+  resize(numBins, history) {
+    this.numBins = numBins;
+    this.history = history;
+    this.ringCanvas.width = history;
+    this.ringCanvas.height = numBins;
+    this.columnImage = new ImageData(1, numBins);
+  }
+
+  // 새로 기록된 열 하나만 오프스크린 링 캔버스로 복사 (RGBA8, 열 하나 = numBins 텍셀이 연속)
+  // heapU8: WASM 메모리, pixelsPtr: 링 텍스처 포인터, column: 방금 기록된 열
+  uploadColumn(heapU8, pixelsPtr, column) {
+    if (!this.columnImage) return;
+
+    const columnBytes = this.numBins * 4;
+    const start = pixelsPtr + column * columnBytes;
+    // ImageData는 SharedArrayBuffer 뷰를 받지 못하므로 열 하나만 복사
+    this.columnImage.data.set(heapU8.subarray(start, start + columnBytes));
+    this.ringContext.putImageData(this.columnImage, column, 0);
+  }
+
+  // 빈 열 구간을 한 번에 채움 (열마다 putImageData 하지 않음)
+  // 색은 C++이 기록한 첫 빈 열의 텍셀(팔레트 0)을 그대로 사용
+  fillColumns(heapU8, pixelsPtr, firstColumn, count) {
+    if (!this.columnImage || count <= 0) return;
+
+    const texel = pixelsPtr + firstColumn * this.numBins * 4;
+    const [r, g, b] = heapU8.subarray(texel, texel + 3);
+    this.ringContext.fillStyle = `rgb(${r}, ${g}, ${b})`;
+
+    // 링 끝에서 넘어가면 두 조각으로 나눠 채움
+    const columns = Math.min(count, this.history);
+    const headWidth = Math.min(columns, this.history - firstColumn);
+    this.ringContext.fillRect(firstColumn, 0, headWidth, this.numBins);
+    if (columns > headWidth) {
+      this.ringContext.fillRect(0, 0, columns - headWidth, this.numBins);
+    }
+  }
+
+  // 링을 화면에 그림 (여러 열을 올린 뒤 한 번만 호출)
+  // writeIndex: 다음에 기록될 열 (= 가장 오래된 열)
+  present(writeIndex) {
+    if (!this.columnImage) return;
+
+    // 링을 두 조각으로 나눠 그려서 스크롤 효과 (GPU blit, 데이터 복사 없음)
+    const { width, height } = this.canvas;
+    const olderWidth = this.history - writeIndex;
+    const splitX = (olderWidth / this.history) * width;
+
+    this.context.save();
+    // 낮은 주파수가 아래쪽에 오도록 세로 반전
+    this.context.translate(0, height);
+    this.context.scale(1, -1);
+    this.context.imageSmoothingEnabled = false;
+    this.context.drawImage(
+      this.ringCanvas,
+      writeIndex, 0, olderWidth, this.numBins,
+      0, 0, splitX, height
+    );
+    if (writeIndex > 0) {
+      this.context.drawImage(
+        this.ringCanvas,
+        0, 0, writeIndex, this.numBins,
+        splitX, 0, width - splitX, height
+      );
+    }
+    this.context.restore();
+  }
+
+  onWindowResize() {
+    this.canvas.width = this.container.clientWidth;
+    this.canvas.height = Math.round(this.container.clientHeight * 0.3);
+  }
+}
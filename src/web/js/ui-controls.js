@@ -9,13 +9,18 @@ export class UIControls {
         const fftSizeSelect = document.getElementById('fft-size');
         fftSizeSelect.addEventListener('change', (e) => {
             const size = parseInt(e.target.value);
-            if (this.app.audioPlayer && this.app.audioPlayer.analyser) {
-                this.app.audioPlayer.analyser.fftSize = size;
-                this.app.audioPlayer.frequencyData = new Uint8Array(this.app.audioPlayer.analyser.frequencyBinCount);
-                console.log(`FFT size changed to: ${size}`);
-            }
+            const option = e.target.selectedOptions[0];
+            this.app.setFFTSize(size, parseInt(option.dataset.fps) || 0);
         });
 
+        // FFT backend selector (auto = planner's measured choice)
+        const fftBackendSelect = document.getElementById('fft-backend');
+        if (fftBackendSelect) {
+            fftBackendSelect.addEventListener('change', (e) => {
+                this.app.setFFTBackend(e.target.value);
+            });
+        }
+
         // Color scheme selector
         const colorSchemeSelect = document.getElementById('color-scheme');
         colorSchemeSelect.addEventListener('change', (e) => {
@@ -25,6 +30,14 @@ export class UIControls {
             }
         });
 
+        // Spectrogram (waterfall) toggle
+        const spectrogramToggle = document.getElementById('spectrogram-toggle');
+        if (spectrogramToggle) {
+            spectrogramToggle.addEventListener('change', (e) => {
+                this.app.setSpectrogramEnabled(e.target.checked);
+            });
+        }
+
         // Sensitivity slider
         const sensitivitySlider = document.getElementById('sensitivity');
         const sensitivityValue = document.getElementById('sensitivity-value');